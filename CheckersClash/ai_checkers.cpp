@@ -7,6 +7,14 @@
  * The CheckersGame class supports both normal and jump moves, king promotion, and
  * game over detection. It also includes a transposition table to store evaluated
  * board states for optimization.
+ *
+ * Positions are keyed by two Zobrist hashes kept up to date by setPiece(): one for
+ * the board as it is, and one for its mirror image (board rotated 180 degrees,
+ * colors swapped, other side to move). The mirror is the same position seen from
+ * the other player, so its score is the negation. The transposition table is keyed
+ * by the smaller of the two hashes, which lets both orientations share one entry.
+ * That only holds for the built-in evaluator; with a network loaded, positions are
+ * keyed by their own hash.
  * 
  * The main methods include:
  * - CheckersGame(): Constructor to initialize the game board.
@@ -14,8 +22,8 @@
  * - isValidPosition(): Checks if a given position is valid on the board.
  * - convertPosition(): Converts a position from notation to row and column indices.
  * - convertToNotation(): Converts row and column indices to board notation.
- * - getJumpMoves(): Generates all possible jump moves for a piece.
- * - getNormalMoves(): Generates all possible normal moves for a piece.
+ * - getJumpMoves(): Generates all possible jump moves for a piece from the precomputed move tables.
+ * - getNormalMoves(): Generates all possible normal moves for a piece from the precomputed move tables.
  * - getValidMoves(): Returns all valid moves for a piece at a given position.
  * - getAllValidMoves(): Returns all valid moves for the current player.
  * - makeMove(): Executes a move on the board.
@@ -24,18 +32,81 @@
  * - minimax(): Implements the minimax algorithm with alpha-beta pruning.
  * - getBestMove(): Determines the best move for the current player based on difficulty.
  * - getPiece(): Returns the piece at a given position.
- * - isGameOver(): Checks if the game is over.
+ * - isGameOver(): Checks if the game is over, either by a player having no moves or by a draw.
+ * - isDraw(): Checks for threefold repetition or the no-progress move limit.
+ * - setNoProgressLimit(): Sets how many plies without a capture or man move end the game as a draw.
+ * - isRepetition(): Checks whether the current position already occurred, used by minimax() to cut cycles.
+ * - repetitionCount(): Counts occurrences of the current position in the history stack.
  * - isValidMove(): Checks if a given move is valid.
- * - boardToString(): Converts the board to a string representation for the transposition table.
+ * - canonicalKey(): Returns the symmetry-canonical position key used by the transposition table.
+ * - probeTransposition() / storeTransposition(): Read and write search results for the current
+ *   position, falling back to the on-disk analysis cache on a miss.
+ * - loadAnalysisCache(): Maps a file of results saved by earlier runs.
+ * - saveAnalysisCache(): Merges this game's deeper search results into a cache file.
+ * - evaluatorFingerprint(): Identifies the evaluator whose scores an analysis cache holds.
  * - isBlackTurn(): Returns whether it is the black player's turn.
+ * - getNodesSearched(): Returns how many positions minimax() has visited.
+ * - loadEvaluator(): Loads neural network weights used by evaluateBoard().
+ * - setPiece(): Writes a square and keeps the position hashes and network accumulator in sync.
  */
 #include "ai_checkers.h"
+#include "move_tables.h"
 #include <iostream>
 #include <algorithm>
 #include <climits>
 
 
-CheckersGame::CheckersGame() : blackTurn(false) {
+namespace {
+    const int NUM_PIECE_KINDS = 4;
+    const int DRAW_SCORE = 0;
+    const uint64_t BUILTIN_EVALUATOR_FINGERPRINT = 0x6275696c74696e31ULL; // "builtin1"
+
+    struct ZobristKeys {
+        uint64_t pieces[NUM_PLAYABLE_SQUARES][NUM_PIECE_KINDS];
+        uint64_t blackToMove;
+
+        ZobristKeys() {
+            // splitmix64 with a fixed seed, so keys are identical across runs
+            uint64_t state = 0x436865636b657273ULL;
+            auto next = [&state]() {
+                uint64_t z = (state += 0x9e3779b97f4a7c15ULL);
+                z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+                z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+                return z ^ (z >> 31);
+            };
+            for (int square = 0; square < NUM_PLAYABLE_SQUARES; square++) {
+                for (int kind = 0; kind < NUM_PIECE_KINDS; kind++) {
+                    pieces[square][kind] = next();
+                }
+            }
+            blackToMove = next();
+        }
+    };
+
+    const ZobristKeys ZOBRIST;
+
+    int pieceKind(PieceType piece) {
+        return static_cast<int>(piece) - 1;
+    }
+
+    // Hash contribution of a piece, and of its mirror image: square rotated 180 degrees
+    // (square index 31 - s) and color swapped (RED <-> BLACK, RED_KING <-> BLACK_KING)
+    uint64_t pieceHash(int row, int col, PieceType piece) {
+        return ZOBRIST.pieces[squareIndex(row, col)][pieceKind(piece)];
+    }
+
+    uint64_t mirroredPieceHash(int row, int col, PieceType piece) {
+        return ZOBRIST.pieces[NUM_PLAYABLE_SQUARES - 1 - squareIndex(row, col)][pieceKind(piece) ^ 1];
+    }
+
+    // Network input feature for a piece on a playable square (4 playable squares per row)
+    int pieceFeature(int row, int col, PieceType piece) {
+        return NnueNetwork::featureIndex(squareIndex(row, col), pieceKind(piece));
+    }
+}
+
+CheckersGame::CheckersGame() : blackTurn(false), positionHash(0), mirroredHash(0), nodesSearched(0), historyDraws(0),
+                               pliesSinceProgress(0), noProgressLimit(DEFAULT_NO_PROGRESS_LIMIT), accumulator() {
     // Initialize empty board
     for (int i = 0; i < BOARD_SIZE; i++) {
         for (int j = 0; j < BOARD_SIZE; j++) {
@@ -59,6 +130,9 @@ CheckersGame::CheckersGame() : blackTurn(false) {
             }
         }
     }
+    
+    refreshHashes();
+    resetHistory();
 }
 
 
@@ -109,25 +183,25 @@ std::string CheckersGame::convertToNotation(int row, int col) const {
 
 void CheckersGame::getJumpMoves(int row, int col, std::vector<Move>& moves) const {
     PieceType currentPiece = board[row][col];
-    bool isKing = (currentPiece == PieceType::RED_KING || currentPiece == PieceType::BLACK_KING);
-    int directions[4][2] = {{1, 1}, {1, -1}, {-1, 1}, {-1, -1}};
+    int kind = static_cast<int>(currentPiece);
+    int square = squareIndex(row, col);
+    bool isRed = (currentPiece == PieceType::RED || currentPiece == PieceType::RED_KING);
     
-    for (auto [dr, dc] : directions) {
-        if (!isKing && ((currentPiece == PieceType::RED && dr < 0) || 
-                       (currentPiece == PieceType::BLACK && dr > 0))) {
+    for (int dir = FIRST_DIRECTION[kind]; dir < LAST_DIRECTION[kind]; dir++) {
+        int landing = MOVE_TABLES.jumpLanding[square][dir];
+        if (landing == NO_SQUARE) {
             continue;
         }
         
-        int newRow = row + dr * 2;
-        int newCol = col + dc * 2;
-        int jumpRow = row + dr;
-        int jumpCol = col + dc;
+        int newRow = MOVE_TABLES.row[landing];
+        int newCol = MOVE_TABLES.col[landing];
+        int over = MOVE_TABLES.neighbour[square][dir];
+        int jumpRow = MOVE_TABLES.row[over];
+        int jumpCol = MOVE_TABLES.col[over];
         
-        if (newRow >= 0 && newRow < BOARD_SIZE && newCol >= 0 && newCol < BOARD_SIZE &&
-            board[newRow][newCol] == PieceType::EMPTY) {
-            
+        if (board[newRow][newCol] == PieceType::EMPTY) {
             PieceType jumpedPiece = board[jumpRow][jumpCol];
-            bool isOpponent = (currentPiece == PieceType::RED || currentPiece == PieceType::RED_KING) ?
+            bool isOpponent = isRed ?
                             (jumpedPiece == PieceType::BLACK || jumpedPiece == PieceType::BLACK_KING) :
                             (jumpedPiece == PieceType::RED || jumpedPiece == PieceType::RED_KING);
             
@@ -142,20 +216,19 @@ void CheckersGame::getJumpMoves(int row, int col, std::vector<Move>& moves) cons
 
 void CheckersGame::getNormalMoves(int row, int col, std::vector<Move>& moves) const {
     PieceType currentPiece = board[row][col];
-    bool isKing = (currentPiece == PieceType::RED_KING || currentPiece == PieceType::BLACK_KING);
-    int directions[4][2] = {{1, 1}, {1, -1}, {-1, 1}, {-1, -1}};
+    int kind = static_cast<int>(currentPiece);
+    int square = squareIndex(row, col);
     
-    for (auto [dr, dc] : directions) {
-        if (!isKing && ((currentPiece == PieceType::RED && dr < 0) || 
-                       (currentPiece == PieceType::BLACK && dr > 0))) {
+    for (int dir = FIRST_DIRECTION[kind]; dir < LAST_DIRECTION[kind]; dir++) {
+        int target = MOVE_TABLES.neighbour[square][dir];
+        if (target == NO_SQUARE) {
             continue;
         }
         
-        int newRow = row + dr;
-        int newCol = col + dc;
+        int newRow = MOVE_TABLES.row[target];
+        int newCol = MOVE_TABLES.col[target];
         
-        if (newRow >= 0 && newRow < BOARD_SIZE && newCol >= 0 && newCol < BOARD_SIZE &&
-            board[newRow][newCol] == PieceType::EMPTY) {
+        if (board[newRow][newCol] == PieceType::EMPTY) {
             Move move = {row, col, newRow, newCol, false, {}};
             moves.push_back(move);
         }
@@ -222,53 +295,83 @@ bool CheckersGame::makeMove(const Move& move) {
         return false;
     }
     
+    UndoRecord record;
+    record.promoted = false;
+    record.pliesSinceProgress = pliesSinceProgress;
+
     // Move the piece
-    board[move.endRow][move.endCol] = board[move.startRow][move.startCol];
-    board[move.startRow][move.startCol] = PieceType::EMPTY;
+    PieceType piece = board[move.startRow][move.startCol];
+    setPiece(move.startRow, move.startCol, PieceType::EMPTY);
+    setPiece(move.endRow, move.endCol, piece);
     
     // Handle captures
     if (move.isJump) {
         for (const auto& capture : move.capturedPieces) {
-            board[capture.first][capture.second] = PieceType::EMPTY;
+            record.capturedTypes.push_back(board[capture.first][capture.second]);
+            setPiece(capture.first, capture.second, PieceType::EMPTY);
         }
     }
     
     // King promotion
-    if (move.endRow == 0 && board[move.endRow][move.endCol] == PieceType::BLACK) {
-        board[move.endRow][move.endCol] = PieceType::BLACK_KING;
+    if (move.endRow == 0 && piece == PieceType::BLACK) {
+        setPiece(move.endRow, move.endCol, PieceType::BLACK_KING);
+        record.promoted = true;
     }
-    else if (move.endRow == BOARD_SIZE - 1 && board[move.endRow][move.endCol] == PieceType::RED) {
-        board[move.endRow][move.endCol] = PieceType::RED_KING;
+    else if (move.endRow == BOARD_SIZE - 1 && piece == PieceType::RED) {
+        setPiece(move.endRow, move.endCol, PieceType::RED_KING);
+        record.promoted = true;
     }
     
+    // Captures and man moves can never be undone in a game, so they restart the no-progress count
+    bool isKingMove = (piece == PieceType::RED_KING || piece == PieceType::BLACK_KING);
+    pliesSinceProgress = (move.isJump || !isKingMove) ? 0 : pliesSinceProgress + 1;
+    
+    undoStack.push_back(record);
     blackTurn = !blackTurn;
+    positionHash ^= ZOBRIST.blackToMove;
+    mirroredHash ^= ZOBRIST.blackToMove;
+    positionHistory.push_back(positionHash);
     return true;
 }
 
 void CheckersGame::undoMove(const Move& move) {
+    if (undoStack.empty()) {
+        return;
+    }
+    UndoRecord record = undoStack.back();
+    undoStack.pop_back();
+
+    // Undo king promotion
+    PieceType piece = board[move.endRow][move.endCol];
+    if (record.promoted) {
+        piece = (piece == PieceType::BLACK_KING) ? PieceType::BLACK : PieceType::RED;
+    }
+
     // Move the piece back to its original position
-    board[move.startRow][move.startCol] = board[move.endRow][move.endCol];
-    board[move.endRow][move.endCol] = PieceType::EMPTY;
+    setPiece(move.endRow, move.endCol, PieceType::EMPTY);
+    setPiece(move.startRow, move.startCol, piece);
 
     // Restore captured pieces
     if (move.isJump) {
-        for (const auto& capture : move.capturedPieces) {
-            board[capture.first][capture.second] = (blackTurn ? PieceType::RED : PieceType::BLACK);
+        for (size_t i = 0; i < move.capturedPieces.size(); i++) {
+            const auto& capture = move.capturedPieces[i];
+            setPiece(capture.first, capture.second, record.capturedTypes[i]);
         }
     }
 
-    // Undo king promotion
-    if (move.endRow == 0 && board[move.startRow][move.startCol] == PieceType::BLACK_KING) {
-        board[move.startRow][move.startCol] = PieceType::BLACK;
-    } else if (move.endRow == BOARD_SIZE - 1 && board[move.startRow][move.startCol] == PieceType::RED_KING) {
-        board[move.startRow][move.startCol] = PieceType::RED;
-    }
-
     // Revert the turn
     blackTurn = !blackTurn;
+    positionHash ^= ZOBRIST.blackToMove;
+    mirroredHash ^= ZOBRIST.blackToMove;
+    positionHistory.pop_back();
+    pliesSinceProgress = record.pliesSinceProgress;
 }
 
 int CheckersGame::evaluateBoard() const {
+    if (network) {
+        return network->evaluate(accumulator);
+    }
+
     int score = 0;
     for (int row = 0; row < BOARD_SIZE; row++) {
         for (int col = 0; col < BOARD_SIZE; col++) {
@@ -311,49 +414,83 @@ std::vector<Move> CheckersGame::orderMoves(const std::vector<Move>& moves) const
 
 
 int CheckersGame::minimax(int depth, bool maximizingPlayer, int alpha, int beta) {
-    std::string boardStr = boardToString();
-    if (transpositionTable.find(boardStr) != transpositionTable.end()) {
-        return transpositionTable[boardStr];
+    nodesSearched++;
+
+    // A repeated position or an exhausted no-progress count is a draw. These depend on the
+    // path to the position, so they are checked before the transposition table and not stored.
+    // historyDraws lets every ancestor notice that its score relied on one.
+    if (isRepetition() || pliesSinceProgress >= noProgressLimit) {
+        historyDraws++;
+        return DRAW_SCORE;
+    }
+
+    TranspositionEntry entry = {0, -1, ScoreBound::EXACT, NO_SQUARE, NO_SQUARE, false};
+    if (probeTransposition(entry) && entry.depth >= depth) {
+        if (entry.bound == ScoreBound::EXACT ||
+            (entry.bound == ScoreBound::LOWER && entry.score >= beta) ||
+            (entry.bound == ScoreBound::UPPER && entry.score <= alpha)) {
+            if (entry.historyDependent) {
+                historyDraws++;
+            }
+            return entry.score;
+        }
     }
 
     if (depth == 0 || isGameOver()) {
         int eval = evaluateBoard();
-        transpositionTable[boardStr] = eval;
+        storeTransposition({eval, depth, ScoreBound::EXACT, NO_SQUARE, NO_SQUARE, false});
         return eval;
     }
 
     std::vector<Move> allMoves = getAllValidMoves(maximizingPlayer);
     allMoves = orderMoves(allMoves); // Order the moves
 
-    if (maximizingPlayer) {
-        int maxEval = INT_MIN;
-        for (const Move& move : allMoves) {
-            makeMove(move);
-            int eval = minimax(depth - 1, false, alpha, beta);
-            undoMove(move);
+    // Try the best move from an earlier search first
+    auto storedBest = std::find_if(allMoves.begin(), allMoves.end(), [&entry](const Move& move) {
+        return squareIndex(move.startRow, move.startCol) == entry.bestFrom &&
+               squareIndex(move.endRow, move.endCol) == entry.bestTo;
+    });
+    if (storedBest != allMoves.end()) {
+        std::rotate(allMoves.begin(), storedBest, storedBest + 1);
+    }
+
+    int originalAlpha = alpha;
+    int originalBeta = beta;
+    long long historyDrawsBefore = historyDraws;
+    int bestEval = maximizingPlayer ? INT_MIN : INT_MAX;
+    const Move* bestMove = nullptr;
+    for (const Move& move : allMoves) {
+        if (!makeMove(move)) {
+            continue;
+        }
+        int eval = minimax(depth - 1, !maximizingPlayer, alpha, beta);
+        undoMove(move);
 
-            maxEval = std::max(maxEval, eval);
-            alpha = std::max(alpha, eval);
-            if (beta <= alpha)
-                break;
+        if (maximizingPlayer ? eval > bestEval : eval < bestEval) {
+            bestEval = eval;
+            bestMove = &move;
         }
-        transpositionTable[boardStr] = maxEval;
-        return maxEval;
-    } else {
-        int minEval = INT_MAX;
-        for (const Move& move : allMoves) {
-            makeMove(move);
-            int eval = minimax(depth - 1, true, alpha, beta);
-            undoMove(move);
-
-            minEval = std::min(minEval, eval);
+        if (maximizingPlayer) {
+            alpha = std::max(alpha, eval);
+        } else {
             beta = std::min(beta, eval);
-            if (beta <= alpha)
-                break;
         }
-        transpositionTable[boardStr] = minEval;
-        return minEval;
+        if (beta <= alpha)
+            break;
+    }
+
+    // A score outside the original window is only a bound on the true value
+    ScoreBound bound = ScoreBound::EXACT;
+    if (bestEval <= originalAlpha) {
+        bound = ScoreBound::UPPER;
+    } else if (bestEval >= originalBeta) {
+        bound = ScoreBound::LOWER;
     }
+    storeTransposition({bestEval, depth, bound,
+                        bestMove ? squareIndex(bestMove->startRow, bestMove->startCol) : NO_SQUARE,
+                        bestMove ? squareIndex(bestMove->endRow, bestMove->endCol) : NO_SQUARE,
+                        historyDraws != historyDrawsBefore});
+    return bestEval;
 }
 
 
@@ -366,24 +503,18 @@ Move CheckersGame::getBestMove(int difficulty) {
         default: depth = 4; break;
     }
     
+    // Scores are from black's point of view, so red picks the lowest one
+    bool maximizing = blackTurn;
     std::vector<Move> allMoves = getAllValidMoves(blackTurn);
     Move bestMove = allMoves[0];
-    int bestValue = INT_MIN;
+    int bestValue = maximizing ? INT_MIN : INT_MAX;
     
     for (const Move& move : allMoves) {
-        // Make move
-        PieceType tempBoard[BOARD_SIZE][BOARD_SIZE];
-        std::copy(&board[0][0], &board[0][0] + BOARD_SIZE * BOARD_SIZE, &tempBoard[0][0]);
-        bool tempTurn = blackTurn;
-        
         makeMove(move);
-        int moveValue = minimax(depth - 1, false, INT_MIN, INT_MAX);
+        int moveValue = minimax(depth - 1, !maximizing, INT_MIN, INT_MAX);
+        undoMove(move);
         
-        // Undo move
-        std::copy(&tempBoard[0][0], &tempBoard[0][0] + BOARD_SIZE * BOARD_SIZE, &board[0][0]);
-        blackTurn = tempTurn;
-        
-        if (moveValue > bestValue) {
+        if (maximizing ? moveValue > bestValue : moveValue < bestValue) {
             bestValue = moveValue;
             bestMove = move;
         }
@@ -400,25 +531,36 @@ PieceType CheckersGame::getPiece(int row, int col) const {
 }
 
 bool CheckersGame::isGameOver() const {
-    bool redHasMoves = false;
-    bool blackHasMoves = false;
+    // The player to move loses when they have no legal move. Only that side matters:
+    // getValidMoves() never returns moves for the player who is not on turn.
+    return isDraw() || getAllValidMoves(blackTurn).empty();
+}
 
-    for (int row = 0; row < BOARD_SIZE; row++) {
-        for (int col = 0; col < BOARD_SIZE; col++) {
-            PieceType piece = getPiece(row, col);
-            if (piece == PieceType::RED || piece == PieceType::RED_KING) {
-                if (!getValidMoves(row, col).empty()) {
-                    redHasMoves = true;
-                }
-            } else if (piece == PieceType::BLACK || piece == PieceType::BLACK_KING) {
-                if (!getValidMoves(row, col).empty()) {
-                    blackHasMoves = true;
-                }
-            }
+bool CheckersGame::isDraw() const {
+    return pliesSinceProgress >= noProgressLimit || repetitionCount() >= 3;
+}
+
+void CheckersGame::setNoProgressLimit(int plies) {
+    // A limit below one would declare the game drawn before anyone moves
+    noProgressLimit = std::max(1, plies);
+}
+
+bool CheckersGame::isRepetition() const {
+    return repetitionCount() >= 2;
+}
+
+int CheckersGame::repetitionCount() const {
+    // Only positions since the last capture or man move can recur, and only with the
+    // same side to move, so step back two plies at a time within that window
+    int count = 1;
+    int current = static_cast<int>(positionHistory.size()) - 1;
+    int oldest = std::max(0, current - pliesSinceProgress);
+    for (int i = current - 2; i >= oldest; i -= 2) {
+        if (positionHistory[i] == positionHash) {
+            count++;
         }
     }
-
-    return !redHasMoves || !blackHasMoves;
+    return count;
 }
 
 bool CheckersGame::isValidMove(const Move& move) const {
@@ -432,16 +574,162 @@ bool CheckersGame::isValidMove(const Move& move) const {
     return false;
 }
 
-std::string CheckersGame::boardToString() const {
-    std::string boardStr;
-    for (int row = 0; row < BOARD_SIZE; ++row) {
-        for (int col = 0; col < BOARD_SIZE; ++col) {
-            boardStr += std::to_string(static_cast<int>(board[row][col]));
+uint64_t CheckersGame::canonicalKey(bool& mirrored) const {
+    // A network is not color-symmetric by construction, so mirrored positions only share
+    // entries with the built-in evaluator, which scores a mirror as the exact negation
+    if (network) {
+        mirrored = false;
+        return positionHash;
+    }
+    mirrored = mirroredHash < positionHash;
+    return mirrored ? mirroredHash : positionHash;
+}
+
+CheckersGame::TranspositionEntry CheckersGame::mirrorEntry(const TranspositionEntry& entry) {
+    TranspositionEntry mirrored = entry;
+    mirrored.score = -entry.score;
+    if (entry.bound == ScoreBound::LOWER) {
+        mirrored.bound = ScoreBound::UPPER;
+    } else if (entry.bound == ScoreBound::UPPER) {
+        mirrored.bound = ScoreBound::LOWER;
+    }
+    if (entry.bestFrom != NO_SQUARE) {
+        mirrored.bestFrom = NUM_PLAYABLE_SQUARES - 1 - entry.bestFrom;
+        mirrored.bestTo = NUM_PLAYABLE_SQUARES - 1 - entry.bestTo;
+    }
+    return mirrored;
+}
+
+bool CheckersGame::probeTransposition(TranspositionEntry& entry) {
+    // Entries are stored for the canonical orientation; a mirrored position scores the negation
+    bool mirrored;
+    uint64_t key = canonicalKey(mirrored);
+    auto found = transpositionTable.find(key);
+    if (found == transpositionTable.end()) {
+        AnalysisRecord record;
+        if (!analysisCache || !analysisCache->find(key, record)) {
+            return false;
+        }
+        TranspositionEntry loaded = {record.score, record.depth, record.bound, record.bestFrom, record.bestTo, false};
+        found = transpositionTable.emplace(key, loaded).first;
+    }
+    entry = mirrored ? mirrorEntry(found->second) : found->second;
+    return true;
+}
+
+void CheckersGame::storeTransposition(const TranspositionEntry& entry) {
+    bool mirrored;
+    uint64_t key = canonicalKey(mirrored);
+    TranspositionEntry canonical = mirrored ? mirrorEntry(entry) : entry;
+    auto found = transpositionTable.find(key);
+    if (found == transpositionTable.end()) {
+        transpositionTable.emplace(key, canonical);
+    } else if (canonical.depth >= found->second.depth) {
+        // Keep deeper results, such as ones loaded from an analysis cache
+        found->second = canonical;
+    }
+}
+
+bool CheckersGame::loadAnalysisCache(const std::string& path) {
+    std::shared_ptr<AnalysisCache> cache = std::make_shared<AnalysisCache>();
+    if (!cache->open(path, evaluatorFingerprint())) {
+        return false;
+    }
+    analysisCache = cache;
+    return true;
+}
+
+bool CheckersGame::saveAnalysisCache(const std::string& path) const {
+    std::vector<AnalysisRecord> records;
+    for (const auto& item : transpositionTable) {
+        const TranspositionEntry& entry = item.second;
+        // Scores that relied on this game's history or draw rule would be wrong in another game
+        if (entry.historyDependent || entry.depth < MIN_SAVED_DEPTH ||
+            entry.score < INT16_MIN || entry.score > INT16_MAX) {
+            continue;
+        }
+        AnalysisRecord record = {};
+        record.key = item.first;
+        record.score = static_cast<int16_t>(entry.score);
+        record.depth = static_cast<uint8_t>(std::min(entry.depth, 255));
+        record.bound = entry.bound;
+        record.bestFrom = static_cast<int8_t>(entry.bestFrom);
+        record.bestTo = static_cast<int8_t>(entry.bestTo);
+        records.push_back(record);
+    }
+    return AnalysisCache::merge(path, evaluatorFingerprint(), records);
+}
+
+uint64_t CheckersGame::evaluatorFingerprint() const {
+    return network ? network->getFingerprint() : BUILTIN_EVALUATOR_FINGERPRINT;
+}
+
+void CheckersGame::resetHistory() {
+    positionHistory.assign(1, positionHash);
+    pliesSinceProgress = 0;
+}
+
+void CheckersGame::refreshHashes() {
+    positionHash = blackTurn ? ZOBRIST.blackToMove : 0;
+    mirroredHash = blackTurn ? 0 : ZOBRIST.blackToMove;
+    for (int row = 0; row < BOARD_SIZE; row++) {
+        for (int col = 0; col < BOARD_SIZE; col++) {
+            if (board[row][col] != PieceType::EMPTY) {
+                positionHash ^= pieceHash(row, col, board[row][col]);
+                mirroredHash ^= mirroredPieceHash(row, col, board[row][col]);
+            }
         }
     }
-    return boardStr;
 }
 
 bool CheckersGame::isBlackTurn() const {
     return blackTurn;
 }
+
+long long CheckersGame::getNodesSearched() const {
+    return nodesSearched;
+}
+
+
+bool CheckersGame::loadEvaluator(const std::string& path) {
+    std::shared_ptr<NnueNetwork> loaded = std::make_shared<NnueNetwork>();
+    if (!loaded->loadWeights(path)) {
+        return false;
+    }
+    network = loaded;
+    refreshAccumulator();
+    // Cached scores came from the previous evaluator
+    transpositionTable.clear();
+    analysisCache.reset();
+    return true;
+}
+
+void CheckersGame::setPiece(int row, int col, PieceType piece) {
+    PieceType previous = board[row][col];
+    if (previous != PieceType::EMPTY) {
+        positionHash ^= pieceHash(row, col, previous);
+        mirroredHash ^= mirroredPieceHash(row, col, previous);
+        if (network) {
+            network->removeFeature(accumulator, pieceFeature(row, col, previous));
+        }
+    }
+    if (piece != PieceType::EMPTY) {
+        positionHash ^= pieceHash(row, col, piece);
+        mirroredHash ^= mirroredPieceHash(row, col, piece);
+        if (network) {
+            network->addFeature(accumulator, pieceFeature(row, col, piece));
+        }
+    }
+    board[row][col] = piece;
+}
+
+void CheckersGame::refreshAccumulator() {
+    network->resetAccumulator(accumulator);
+    for (int row = 0; row < BOARD_SIZE; row++) {
+        for (int col = 0; col < BOARD_SIZE; col++) {
+            if (board[row][col] != PieceType::EMPTY) {
+                network->addFeature(accumulator, pieceFeature(row, col, board[row][col]));
+            }
+        }
+    }
+}
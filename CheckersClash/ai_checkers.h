@@ -2,9 +2,13 @@
 #ifndef AI_CHECKERS_H
 #define AI_CHECKERS_H
 
+#include <cstdint>
 #include <vector>
 #include <string>
 #include <unordered_map>
+#include <memory>
+#include "nnue_eval.h"
+#include "analysis_cache.h"
 
 
 enum class PieceType {
@@ -27,19 +31,67 @@ class CheckersGame {
         std::vector<Move> getValidMoves(int row, int col) const;
         std::vector<Move> getAllValidMoves(bool isBlackTurn) const;
         bool isGameOver() const;
+        bool isDraw() const;
+        void setNoProgressLimit(int plies); // Values below 1 are raised to 1
         Move getBestMove(int difficulty);
         bool isValidPosition(const std::string& pos) const;
         std::pair<int, int> convertPosition(const std::string& pos) const;
         std::string convertToNotation(int row, int col) const;
         PieceType getPiece(int row, int col) const;
         bool isBlackTurn() const;
+        long long getNodesSearched() const;
+        bool loadEvaluator(const std::string& path);
+        bool loadAnalysisCache(const std::string& path);
+        bool saveAnalysisCache(const std::string& path) const;
     
     private:
         static const int BOARD_SIZE = 8;
+        static const int DEFAULT_NO_PROGRESS_LIMIT = 80; // 40 moves per side without a capture or man move
+        static const int MIN_SAVED_DEPTH = 2; // Shallower results are cheaper to recompute than to store
+
+        // What makeMove() changed beyond the moved piece, so undoMove() can restore it exactly
+        struct UndoRecord {
+            std::vector<PieceType> capturedTypes;
+            bool promoted;
+            int pliesSinceProgress;
+        };
+
+        // A search result for one position; best move squares are playable-square indices or -1.
+        // historyDependent marks scores that relied on a repetition or no-progress draw.
+        struct TranspositionEntry {
+            int score;
+            int depth;
+            ScoreBound bound;
+            int bestFrom;
+            int bestTo;
+            bool historyDependent;
+        };
+
         PieceType board[BOARD_SIZE][BOARD_SIZE];
         bool blackTurn;
-        std::unordered_map<std::string, int> transpositionTable;
-        std::string boardToString() const;
+        uint64_t positionHash;
+        uint64_t mirroredHash;
+        std::unordered_map<uint64_t, TranspositionEntry> transpositionTable;
+        long long nodesSearched;
+        long long historyDraws; // Draws by repetition or no progress returned by minimax() so far
+        std::vector<UndoRecord> undoStack;
+        std::vector<uint64_t> positionHistory; // positionHash of every position in the game and current search line
+        int pliesSinceProgress;
+        int noProgressLimit;
+        std::shared_ptr<const NnueNetwork> network;
+        std::shared_ptr<const AnalysisCache> analysisCache;
+        NnueAccumulator accumulator;
+        uint64_t canonicalKey(bool& mirrored) const;
+        static TranspositionEntry mirrorEntry(const TranspositionEntry& entry);
+        bool probeTransposition(TranspositionEntry& entry);
+        void storeTransposition(const TranspositionEntry& entry);
+        uint64_t evaluatorFingerprint() const;
+        void refreshHashes();
+        void resetHistory();
+        bool isRepetition() const;
+        int repetitionCount() const;
+        void setPiece(int row, int col, PieceType piece);
+        void refreshAccumulator();
         
         int minimax(int depth, bool maximizingPlayer, int alpha, int beta);
         void undoMove(const Move& move);
@@ -0,0 +1,233 @@
+/**
+ * This file contains the implementation of the AnalysisCache class, which maps a
+ * file of saved search results into memory and merges new results into it.
+ *
+ * The main methods include:
+ * - open(): Maps an existing cache file read-only and validates its header and evaluator.
+ * - close(): Unmaps the file.
+ * - find(): Binary-searches the mapped records for a position key.
+ * - merge(): Combines new records with a file's contents and rewrites it under a file lock.
+ */
+#include "analysis_cache.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/file.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+
+namespace {
+    const char CACHE_MAGIC[4] = {'C', 'K', 'A', 'C'};
+    const uint32_t CACHE_VERSION = 2;
+
+    struct CacheHeader {
+        char magic[4];
+        uint32_t version;
+        uint64_t evaluator;
+        uint64_t count;
+    };
+
+    // True when path holds a cache header written for a different evaluator
+    bool belongsToOtherEvaluator(const std::string& path, uint64_t evaluator) {
+        CacheHeader header;
+        FILE* in = std::fopen(path.c_str(), "rb");
+        if (!in) {
+            return false;
+        }
+        bool readHeader = std::fread(&header, sizeof(header), 1, in) == 1;
+        std::fclose(in);
+        return readHeader && std::memcmp(header.magic, CACHE_MAGIC, 4) == 0 &&
+               header.version == CACHE_VERSION && header.evaluator != evaluator;
+    }
+
+    // Deeper results win; at equal depth an exact score beats a bound
+    bool isBetter(const AnalysisRecord& candidate, const AnalysisRecord& current) {
+        if (candidate.depth != current.depth) {
+            return candidate.depth > current.depth;
+        }
+        return candidate.bound == ScoreBound::EXACT && current.bound != ScoreBound::EXACT;
+    }
+
+    bool keyLess(const AnalysisRecord& a, const AnalysisRecord& b) {
+        return a.key < b.key;
+    }
+
+    // Exclusive flock() on a side file, held for the lifetime of the object
+    class FileLock {
+        public:
+            explicit FileLock(const std::string& path) : fd(::open(path.c_str(), O_RDWR | O_CREAT, 0644)) {
+                if (fd >= 0 && flock(fd, LOCK_EX) != 0) {
+                    ::close(fd);
+                    fd = -1;
+                }
+            }
+            ~FileLock() {
+                if (fd >= 0) {
+                    flock(fd, LOCK_UN);
+                    ::close(fd);
+                }
+            }
+            FileLock(const FileLock&) = delete;
+            FileLock& operator=(const FileLock&) = delete;
+            bool isLocked() const {
+                return fd >= 0;
+            }
+
+        private:
+            int fd;
+    };
+}
+
+
+AnalysisCache::AnalysisCache() : mapping(nullptr), mappingSize(0), records(nullptr), count(0) {}
+
+
+AnalysisCache::~AnalysisCache() {
+    close();
+}
+
+
+bool AnalysisCache::open(const std::string& path, uint64_t evaluator) {
+    close();
+
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return false;
+    }
+
+    struct stat info;
+    if (fstat(fd, &info) != 0 || static_cast<size_t>(info.st_size) < sizeof(CacheHeader)) {
+        ::close(fd);
+        return false;
+    }
+
+    size_t fileSize = static_cast<size_t>(info.st_size);
+    void* data = mmap(nullptr, fileSize, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (data == MAP_FAILED) {
+        return false;
+    }
+
+    // Derive the record count from the file size rather than multiplying the header's
+    // count, which a corrupt file could make overflow
+    const CacheHeader* header = static_cast<const CacheHeader*>(data);
+    size_t payloadSize = fileSize - sizeof(CacheHeader);
+    if (std::memcmp(header->magic, CACHE_MAGIC, 4) != 0 || header->version != CACHE_VERSION ||
+        header->evaluator != evaluator || payloadSize % sizeof(AnalysisRecord) != 0 ||
+        header->count != payloadSize / sizeof(AnalysisRecord)) {
+        munmap(data, fileSize);
+        return false;
+    }
+
+    mapping = data;
+    mappingSize = fileSize;
+    records = reinterpret_cast<const AnalysisRecord*>(static_cast<const char*>(data) + sizeof(CacheHeader));
+    count = static_cast<size_t>(header->count);
+    return true;
+}
+
+
+void AnalysisCache::close() {
+    if (mapping) {
+        munmap(mapping, mappingSize);
+    }
+    mapping = nullptr;
+    mappingSize = 0;
+    records = nullptr;
+    count = 0;
+}
+
+
+size_t AnalysisCache::size() const {
+    return count;
+}
+
+
+bool AnalysisCache::find(uint64_t key, AnalysisRecord& record) const {
+    AnalysisRecord probe = {};
+    probe.key = key;
+    const AnalysisRecord* found = std::lower_bound(records, records + count, probe, keyLess);
+    if (found == records + count || found->key != key) {
+        return false;
+    }
+    record = *found;
+    return true;
+}
+
+
+bool AnalysisCache::merge(const std::string& path, uint64_t evaluator, std::vector<AnalysisRecord> newRecords) {
+    // Sort the new records and keep the best one per key
+    std::stable_sort(newRecords.begin(), newRecords.end(), keyLess);
+    std::vector<AnalysisRecord> incoming;
+    for (const AnalysisRecord& record : newRecords) {
+        if (!incoming.empty() && incoming.back().key == record.key) {
+            if (isBetter(record, incoming.back())) {
+                incoming.back() = record;
+            }
+        } else {
+            incoming.push_back(record);
+        }
+    }
+
+    // Runs sharing a cache take turns through the read, merge and rename below, so none
+    // of them replaces the file with a version missing another run's records
+    FileLock lock(path + ".lock");
+    if (!lock.isLocked()) {
+        return false;
+    }
+
+    // Merge with whatever the file already holds; a missing or invalid file starts empty,
+    // but another evaluator's results are left alone rather than overwritten
+    AnalysisCache existing;
+    if (!existing.open(path, evaluator) && belongsToOtherEvaluator(path, evaluator)) {
+        return false;
+    }
+    std::vector<AnalysisRecord> merged;
+    merged.reserve(existing.count + incoming.size());
+    size_t i = 0, j = 0;
+    while (i < existing.count || j < incoming.size()) {
+        if (j == incoming.size() || (i < existing.count && existing.records[i].key < incoming[j].key)) {
+            merged.push_back(existing.records[i++]);
+        } else if (i == existing.count || incoming[j].key < existing.records[i].key) {
+            merged.push_back(incoming[j++]);
+        } else {
+            merged.push_back(isBetter(incoming[j], existing.records[i]) ? incoming[j] : existing.records[i]);
+            i++;
+            j++;
+        }
+    }
+    existing.close();
+
+    // Write a uniquely named temporary file and rename it over the old one, so readers
+    // never see a partial file
+    std::string tempTemplate = path + ".XXXXXX";
+    std::vector<char> tempPath(tempTemplate.begin(), tempTemplate.end());
+    tempPath.push_back('\0');
+    int fd = mkstemp(tempPath.data());
+    if (fd < 0) {
+        return false;
+    }
+    fchmod(fd, 0644);
+    FILE* out = fdopen(fd, "wb");
+    if (!out) {
+        ::close(fd);
+        std::remove(tempPath.data());
+        return false;
+    }
+    CacheHeader header;
+    std::memcpy(header.magic, CACHE_MAGIC, 4);
+    header.version = CACHE_VERSION;
+    header.evaluator = evaluator;
+    header.count = merged.size();
+    bool ok = std::fwrite(&header, sizeof(header), 1, out) == 1 &&
+              std::fwrite(merged.data(), sizeof(AnalysisRecord), merged.size(), out) == merged.size();
+    ok = (std::fclose(out) == 0) && ok;
+    if (!ok || std::rename(tempPath.data(), path.c_str()) != 0) {
+        std::remove(tempPath.data());
+        return false;
+    }
+    return true;
+}
@@ -0,0 +1,61 @@
+//Creators: Uzair Azizuddin Firas Al Halaq
+#ifndef ANALYSIS_CACHE_H
+#define ANALYSIS_CACHE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * On-disk cache of search results that survives between runs.
+ *
+ * The file is a 24-byte header followed by AnalysisRecords sorted by key, so it can
+ * be memory-mapped read-only and searched in place without parsing. merge() folds
+ * new records into an existing file, keeping the deeper result for each key, and
+ * replaces it atomically. Merges hold an flock() on "<path>.lock", so several runs
+ * can share one cache file without losing each other's records.
+ *
+ * Keys are CheckersGame's canonical position keys. Scores are only meaningful for the
+ * evaluator that produced them, so the header records that evaluator's fingerprint;
+ * open() rejects a file written for a different one and merge() refuses to touch it.
+ */
+
+enum class ScoreBound : uint8_t {
+    EXACT, LOWER, UPPER
+};
+
+struct AnalysisRecord {
+    uint64_t key;
+    int16_t score;
+    uint8_t depth;
+    ScoreBound bound;
+    int8_t bestFrom;   // playable-square index of the best move, -1 if none
+    int8_t bestTo;
+    uint16_t reserved;
+};
+
+static_assert(sizeof(AnalysisRecord) == 16, "AnalysisRecord is part of the file format");
+
+class AnalysisCache {
+    public:
+        AnalysisCache();
+        ~AnalysisCache();
+        AnalysisCache(const AnalysisCache&) = delete;
+        AnalysisCache& operator=(const AnalysisCache&) = delete;
+
+        bool open(const std::string& path, uint64_t evaluator);
+        void close();
+        size_t size() const;
+        bool find(uint64_t key, AnalysisRecord& record) const;
+
+        static bool merge(const std::string& path, uint64_t evaluator, std::vector<AnalysisRecord> records);
+
+    private:
+        void* mapping;
+        size_t mappingSize;
+        const AnalysisRecord* records;
+        size_t count;
+};
+
+#endif
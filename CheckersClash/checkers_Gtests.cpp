@@ -1,5 +1,39 @@
 #include "ai_checkers.h"
 #include <gtest/gtest.h>
+#include <climits>
+#include <cstdio>
+#include <fstream>
+#include <thread>
+
+// Writes a small deterministic network so evaluator tests don't depend on a trained file
+static void writeTestWeights(const std::string& path) {
+    std::ofstream out(path, std::ios::binary);
+    out.write("CKNN", 4);
+    uint32_t version = 1;
+    out.write(reinterpret_cast<const char*>(&version), sizeof(version));
+    for (int i = 0; i < NnueNetwork::HIDDEN1; i++) {
+        int16_t bias = static_cast<int16_t>(i % 7);
+        out.write(reinterpret_cast<const char*>(&bias), sizeof(bias));
+    }
+    for (int i = 0; i < NnueNetwork::NUM_FEATURES * NnueNetwork::HIDDEN1; i++) {
+        int16_t weight = static_cast<int16_t>((i * 37) % 23 - 8);
+        out.write(reinterpret_cast<const char*>(&weight), sizeof(weight));
+    }
+    for (int i = 0; i < NnueNetwork::HIDDEN2; i++) {
+        int32_t bias = 16;
+        out.write(reinterpret_cast<const char*>(&bias), sizeof(bias));
+    }
+    for (int i = 0; i < NnueNetwork::HIDDEN2 * NnueNetwork::HIDDEN1; i++) {
+        int8_t weight = static_cast<int8_t>((i * 13) % 9 - 4);
+        out.write(reinterpret_cast<const char*>(&weight), sizeof(weight));
+    }
+    int32_t outputBias = 0;
+    out.write(reinterpret_cast<const char*>(&outputBias), sizeof(outputBias));
+    for (int i = 0; i < NnueNetwork::HIDDEN2; i++) {
+        int8_t weight = static_cast<int8_t>(i % 2 == 0 ? 50 : -50);
+        out.write(reinterpret_cast<const char*>(&weight), sizeof(weight));
+    }
+}
 
 class CheckersGameTest : public ::testing::Test {
 protected:
@@ -156,6 +190,492 @@ TEST(CheckersGameTest, GameOver) {
     EXPECT_TRUE(game.isGameOver());
 }
 
+// Counts the leaf positions reached by playing every legal move to the given depth
+static long long perft(CheckersGame& game, int depth) {
+    if (depth == 0) {
+        return 1;
+    }
+    long long nodes = 0;
+    for (const Move& move : game.getAllValidMoves(game.isBlackTurn())) {
+        game.makeMove(move);
+        nodes += perft(game, depth - 1);
+        game.undoMove(move);
+    }
+    return nodes;
+}
+
+TEST(MoveGenerationTest, PerftFromStartPosition) {
+    // Counts from the move generator before it switched to precomputed tables
+    const long long expected[] = {7, 49, 302, 1469, 7361, 36768};
+    CheckersGame game;
+    for (int depth = 1; depth <= 6; depth++) {
+        EXPECT_EQ(perft(game, depth), expected[depth - 1]) << "depth " << depth;
+    }
+}
+
+TEST(NnueNetworkTest, IncrementalUpdatesMatchRefresh) {
+    const std::string path = "test_weights.nnue";
+    writeTestWeights(path);
+    NnueNetwork network;
+    ASSERT_TRUE(network.loadWeights(path));
+    std::remove(path.c_str());
+
+    NnueAccumulator fresh;
+    network.resetAccumulator(fresh);
+    network.addFeature(fresh, NnueNetwork::featureIndex(5, 0));
+    network.addFeature(fresh, NnueNetwork::featureIndex(20, 3));
+
+    NnueAccumulator incremental;
+    network.resetAccumulator(incremental);
+    network.addFeature(incremental, NnueNetwork::featureIndex(20, 3));
+    network.addFeature(incremental, NnueNetwork::featureIndex(9, 1));
+    network.addFeature(incremental, NnueNetwork::featureIndex(5, 0));
+    network.removeFeature(incremental, NnueNetwork::featureIndex(9, 1));
+
+    for (int i = 0; i < NnueNetwork::HIDDEN1; i++) {
+        EXPECT_EQ(fresh.values[i], incremental.values[i]);
+    }
+    EXPECT_EQ(network.evaluate(fresh), network.evaluate(incremental));
+}
+
+TEST(NnueNetworkTest, RejectsMissingOrTruncatedWeights) {
+    NnueNetwork network;
+    EXPECT_FALSE(network.loadWeights("does_not_exist.nnue"));
+
+    const std::string path = "truncated_weights.nnue";
+    {
+        std::ofstream out(path, std::ios::binary);
+        out.write("CKNN", 4);
+    }
+    EXPECT_FALSE(network.loadWeights(path));
+    std::remove(path.c_str());
+}
+
+TEST(NnueNetworkTest, RejectsWeightsWithTrailingBytes) {
+    const std::string path = "oversized_weights.nnue";
+    writeTestWeights(path);
+    NnueNetwork network;
+    ASSERT_TRUE(network.loadWeights(path));
+    uint64_t fingerprint = network.getFingerprint();
+    {
+        std::ofstream out(path, std::ios::binary | std::ios::app);
+        out.write("\0\0\0\0", 4);
+    }
+    EXPECT_FALSE(network.loadWeights(path));
+    EXPECT_EQ(network.getFingerprint(), fingerprint);
+    std::remove(path.c_str());
+}
+
+TEST_F(CheckersGameTest, LoadEvaluator) {
+    EXPECT_FALSE(game.loadEvaluator("does_not_exist.nnue"));
+
+    const std::string path = "game_weights.nnue";
+    writeTestWeights(path);
+    EXPECT_TRUE(game.loadEvaluator(path));
+    std::remove(path.c_str());
+
+    Move bestMove = game.getBestMove(2);
+    EXPECT_TRUE(game.makeMove(bestMove));
+}
+
+TEST_F(CheckersGameTest, MakeAndUndoKeepAccumulatorInSync) {
+    for (int row = 0; row < 8; ++row) {
+        for (int col = 0; col < 8; ++col) {
+            game.board[row][col] = PieceType::EMPTY;
+        }
+    }
+    game.board[5][2] = PieceType::RED;
+    game.board[6][3] = PieceType::BLACK;
+    game.board[2][5] = PieceType::BLACK_KING;
+    game.blackTurn = false;
+    game.refreshHashes();
+    game.resetHistory();
+
+    const std::string path = "sync_weights.nnue";
+    writeTestWeights(path);
+    ASSERT_TRUE(game.loadEvaluator(path));
+    std::remove(path.c_str());
+
+    auto expectInSync = [this]() {
+        NnueAccumulator incremental = game.accumulator;
+        game.refreshAccumulator();
+        for (int i = 0; i < NnueNetwork::HIDDEN1; i++) {
+            EXPECT_EQ(incremental.values[i], game.accumulator.values[i]);
+        }
+    };
+
+    // Capture that also promotes, then a king move for each side
+    std::vector<Move> line = {
+        {5, 2, 7, 4, true, {{6, 3}}},
+        {2, 5, 3, 4, false, {}},
+        {7, 4, 6, 3, false, {}},
+    };
+    for (const Move& move : line) {
+        ASSERT_TRUE(game.makeMove(move));
+        expectInSync();
+    }
+    EXPECT_EQ(game.getPiece(6, 3), PieceType::RED_KING);
+
+    for (auto move = line.rbegin(); move != line.rend(); ++move) {
+        game.undoMove(*move);
+        expectInSync();
+    }
+    EXPECT_EQ(game.getPiece(5, 2), PieceType::RED);
+    EXPECT_EQ(game.getPiece(6, 3), PieceType::BLACK);
+}
+
+TEST_F(CheckersGameTest, MirroredPositionsShareKey) {
+    // Rotate 180 degrees and swap colors and side to move
+    auto setUp = [](CheckersGame& target, bool mirror) {
+        for (int row = 0; row < 8; ++row) {
+            for (int col = 0; col < 8; ++col) {
+                target.board[row][col] = PieceType::EMPTY;
+            }
+        }
+        if (mirror) {
+            target.board[5][6] = PieceType::BLACK;
+            target.board[3][4] = PieceType::RED;
+        } else {
+            target.board[2][1] = PieceType::RED;
+            target.board[4][3] = PieceType::BLACK;
+        }
+        target.blackTurn = mirror;
+        target.refreshHashes();
+        target.resetHistory();
+    };
+
+    CheckersGame mirrored;
+    setUp(game, false);
+    setUp(mirrored, true);
+    bool gameMirrored, otherMirrored;
+    EXPECT_EQ(game.canonicalKey(gameMirrored), mirrored.canonicalKey(otherMirrored));
+    EXPECT_NE(gameMirrored, otherMirrored);
+
+    // Searching the mirror in the same game is answered by the first search's entry
+    int score = game.minimax(4, false, INT_MIN, INT_MAX);
+    ASSERT_NE(score, 0);
+    setUp(game, true);
+    long long nodesBefore = game.getNodesSearched();
+    EXPECT_EQ(game.minimax(4, true, INT_MIN, INT_MAX), -score);
+    EXPECT_EQ(game.getNodesSearched(), nodesBefore + 1);
+}
+
+TEST_F(CheckersGameTest, NetworkSearchDoesNotShareMirroredEntries) {
+    // The network is not color-symmetric, so a mirrored position must not reuse the
+    // negated score of its twin. Search a position, then its mirror in the same game,
+    // and compare with a game that only ever saw the mirror.
+    const std::string path = "mirror_weights.nnue";
+    writeTestWeights(path);
+    CheckersGame fresh;
+    ASSERT_TRUE(game.loadEvaluator(path));
+    ASSERT_TRUE(fresh.loadEvaluator(path));
+    std::remove(path.c_str());
+
+    auto setUp = [](CheckersGame& target, bool mirror) {
+        for (int row = 0; row < 8; ++row) {
+            for (int col = 0; col < 8; ++col) {
+                target.board[row][col] = PieceType::EMPTY;
+            }
+        }
+        if (mirror) {
+            target.board[5][6] = PieceType::BLACK;
+            target.board[3][4] = PieceType::RED_KING;
+        } else {
+            target.board[2][1] = PieceType::RED;
+            target.board[4][3] = PieceType::BLACK_KING;
+        }
+        target.blackTurn = mirror;
+        target.refreshHashes();
+        target.resetHistory();
+        target.refreshAccumulator();
+    };
+
+    setUp(game, false);
+    game.minimax(1, false, INT_MIN, INT_MAX);
+    setUp(game, true);
+    int shared = game.minimax(1, true, INT_MIN, INT_MAX);
+
+    setUp(fresh, true);
+    int unshared = fresh.minimax(1, true, INT_MIN, INT_MAX);
+    EXPECT_EQ(shared, unshared);
+}
+
+TEST_F(CheckersGameTest, PositionHashIsIncremental) {
+    bool mirrored;
+    uint64_t initialKey = game.canonicalKey(mirrored);
+    Move move = {2, 1, 3, 2, false, {}};
+    ASSERT_TRUE(game.makeMove(move));
+    uint64_t movedKey = game.canonicalKey(mirrored);
+    EXPECT_NE(initialKey, movedKey);
+
+    uint64_t positionHash = game.positionHash;
+    uint64_t mirroredHash = game.mirroredHash;
+    game.refreshHashes();
+    EXPECT_EQ(positionHash, game.positionHash);
+    EXPECT_EQ(mirroredHash, game.mirroredHash);
+
+    game.undoMove(move);
+    EXPECT_EQ(initialKey, game.canonicalKey(mirrored));
+}
+
+// Leaves one red king and one black king in opposite corners, red to move
+static void setUpKingEndgame(CheckersGame& game) {
+    for (int row = 0; row < 8; ++row) {
+        for (int col = 0; col < 8; ++col) {
+            game.board[row][col] = PieceType::EMPTY;
+        }
+    }
+    game.board[0][1] = PieceType::RED_KING;
+    game.board[7][6] = PieceType::BLACK_KING;
+    game.blackTurn = false;
+    game.refreshHashes();
+    game.resetHistory();
+}
+
+TEST_F(CheckersGameTest, ThreefoldRepetitionIsDraw) {
+    setUpKingEndgame(game);
+    Move redOut = {0, 1, 1, 2, false, {}};
+    Move blackOut = {7, 6, 6, 5, false, {}};
+    Move redBack = {1, 2, 0, 1, false, {}};
+    Move blackBack = {6, 5, 7, 6, false, {}};
+
+    for (int cycle = 1; cycle <= 2; ++cycle) {
+        EXPECT_FALSE(game.isDraw());
+        ASSERT_TRUE(game.makeMove(redOut));
+        ASSERT_TRUE(game.makeMove(blackOut));
+        ASSERT_TRUE(game.makeMove(redBack));
+        ASSERT_TRUE(game.makeMove(blackBack));
+        EXPECT_TRUE(game.isRepetition());
+    }
+    EXPECT_TRUE(game.isDraw());
+    EXPECT_TRUE(game.isGameOver());
+
+    game.undoMove(blackBack);
+    EXPECT_FALSE(game.isDraw());
+}
+
+TEST_F(CheckersGameTest, NoProgressLimitIsDraw) {
+    setUpKingEndgame(game);
+    game.setNoProgressLimit(3);
+    ASSERT_TRUE(game.makeMove({0, 1, 1, 2, false, {}}));
+    ASSERT_TRUE(game.makeMove({7, 6, 6, 5, false, {}}));
+    EXPECT_FALSE(game.isDraw());
+    ASSERT_TRUE(game.makeMove({1, 2, 2, 3, false, {}}));
+    EXPECT_TRUE(game.isDraw());
+    EXPECT_FALSE(game.isRepetition());
+}
+
+TEST_F(CheckersGameTest, NoProgressLimitIsAtLeastOnePly) {
+    setUpKingEndgame(game);
+    game.setNoProgressLimit(0);
+    EXPECT_FALSE(game.isGameOver());
+    ASSERT_TRUE(game.makeMove({0, 1, 1, 2, false, {}}));
+    EXPECT_TRUE(game.isDraw());
+
+    game.undoMove({0, 1, 1, 2, false, {}});
+    game.setNoProgressLimit(-5);
+    EXPECT_FALSE(game.isDraw());
+}
+
+// Leaves two red kings against one black king, red to move. The built-in evaluator
+// scores this -15, so a search that returns 0 must have found a draw.
+static void setUpUnevenKingEndgame(CheckersGame& game) {
+    setUpKingEndgame(game);
+    game.board[0][5] = PieceType::RED_KING;
+    game.refreshHashes();
+    game.resetHistory();
+}
+
+TEST_F(CheckersGameTest, MinimaxScoresRepetitionAsDraw) {
+    setUpUnevenKingEndgame(game);
+    ASSERT_EQ(game.evaluateBoard(), -15);
+    ASSERT_TRUE(game.makeMove({0, 1, 1, 2, false, {}}));
+    ASSERT_TRUE(game.makeMove({7, 6, 6, 5, false, {}}));
+    ASSERT_TRUE(game.makeMove({1, 2, 0, 1, false, {}}));
+
+    // Black is behind, and moving its king back repeats the starting position
+    EXPECT_EQ(game.minimax(1, true, INT_MIN, INT_MAX), 0);
+
+    // Once the position has repeated, the search stops there
+    ASSERT_TRUE(game.makeMove({6, 5, 7, 6, false, {}}));
+    EXPECT_EQ(game.minimax(4, false, INT_MIN, INT_MAX), 0);
+}
+
+TEST_F(CheckersGameTest, MinimaxScoresNoProgressLimitAsDraw) {
+    setUpUnevenKingEndgame(game);
+    ASSERT_TRUE(game.makeMove({0, 1, 1, 2, false, {}}));
+    EXPECT_EQ(game.minimax(1, true, INT_MIN, INT_MAX), -15);
+
+    // Every black move now reaches the limit, so black can hold the draw
+    game.transpositionTable.clear();
+    game.setNoProgressLimit(2);
+    EXPECT_EQ(game.minimax(1, true, INT_MIN, INT_MAX), 0);
+}
+
+TEST_F(CheckersGameTest, HistoryDependentScoresAreNotSaved) {
+    // With the kings one move away from their starting squares, the search runs into
+    // repetitions of earlier game positions; those scores must stay out of the cache
+    setUpKingEndgame(game);
+    game.makeMove({0, 1, 1, 2, false, {}});
+    game.makeMove({7, 6, 6, 5, false, {}});
+    game.minimax(4, false, INT_MIN, INT_MAX);
+
+    int dependent = 0;
+    for (const auto& item : game.transpositionTable) {
+        if (item.second.historyDependent) {
+            dependent++;
+        }
+    }
+    ASSERT_GT(dependent, 0);
+
+    const std::string path = "history_analysis.cache";
+    std::remove(path.c_str());
+    ASSERT_TRUE(game.saveAnalysisCache(path));
+    AnalysisCache cache;
+    ASSERT_TRUE(cache.open(path, game.evaluatorFingerprint()));
+    AnalysisRecord record;
+    for (const auto& item : game.transpositionTable) {
+        if (item.second.historyDependent) {
+            EXPECT_FALSE(cache.find(item.first, record));
+        }
+    }
+    cache.close();
+    std::remove(path.c_str());
+    std::remove((path + ".lock").c_str());
+}
+
+TEST(AnalysisCacheTest, MergeKeepsDeeperResults) {
+    const std::string path = "test_analysis.cache";
+    std::remove(path.c_str());
+
+    AnalysisRecord shallow = {42, 10, 2, ScoreBound::EXACT, 5, 9, 0};
+    AnalysisRecord other = {7, -3, 4, ScoreBound::LOWER, -1, -1, 0};
+    ASSERT_TRUE(AnalysisCache::merge(path, 1, {shallow, other}));
+
+    AnalysisRecord deeper = {42, 25, 6, ScoreBound::UPPER, 1, 5, 0};
+    AnalysisRecord shallower = {7, 99, 1, ScoreBound::EXACT, -1, -1, 0};
+    ASSERT_TRUE(AnalysisCache::merge(path, 1, {deeper, shallower}));
+
+    AnalysisCache cache;
+    ASSERT_TRUE(cache.open(path, 1));
+    EXPECT_EQ(cache.size(), 2u);
+
+    AnalysisRecord found;
+    ASSERT_TRUE(cache.find(42, found));
+    EXPECT_EQ(found.score, 25);
+    EXPECT_EQ(found.depth, 6);
+    EXPECT_EQ(found.bound, ScoreBound::UPPER);
+    ASSERT_TRUE(cache.find(7, found));
+    EXPECT_EQ(found.score, -3);
+    EXPECT_FALSE(cache.find(8, found));
+
+    cache.close();
+    std::remove(path.c_str());
+    std::remove((path + ".lock").c_str());
+}
+
+TEST(AnalysisCacheTest, RejectsOtherEvaluators) {
+    const std::string path = "evaluator_analysis.cache";
+    std::remove(path.c_str());
+
+    AnalysisRecord record = {42, 10, 2, ScoreBound::EXACT, -1, -1, 0};
+    ASSERT_TRUE(AnalysisCache::merge(path, 1, {record}));
+    EXPECT_FALSE(AnalysisCache::merge(path, 2, {record}));
+
+    AnalysisCache cache;
+    EXPECT_FALSE(cache.open(path, 2));
+    EXPECT_TRUE(cache.open(path, 1));
+    EXPECT_EQ(cache.size(), 1u);
+
+    cache.close();
+    std::remove(path.c_str());
+    std::remove((path + ".lock").c_str());
+}
+
+TEST(AnalysisCacheTest, ConcurrentMergesKeepAllRecords) {
+    const std::string path = "concurrent_analysis.cache";
+    std::remove(path.c_str());
+
+    const int writers = 4;
+    const int mergesPerWriter = 20;
+    std::vector<std::thread> threads;
+    for (int writer = 0; writer < writers; writer++) {
+        threads.emplace_back([&path, writer]() {
+            for (int i = 0; i < mergesPerWriter; i++) {
+                AnalysisRecord record = {static_cast<uint64_t>(writer * 1000 + i), 1, 3, ScoreBound::EXACT, -1, -1, 0};
+                EXPECT_TRUE(AnalysisCache::merge(path, 1, {record}));
+            }
+        });
+    }
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+
+    AnalysisCache cache;
+    ASSERT_TRUE(cache.open(path, 1));
+    EXPECT_EQ(cache.size(), static_cast<size_t>(writers * mergesPerWriter));
+    cache.close();
+    std::remove(path.c_str());
+    std::remove((path + ".lock").c_str());
+}
+
+TEST(AnalysisCacheTest, RejectsMissingOrCorruptFiles) {
+    AnalysisCache cache;
+    EXPECT_FALSE(cache.open("does_not_exist.cache", 1));
+
+    const std::string path = "corrupt_analysis.cache";
+    {
+        std::ofstream out(path, std::ios::binary);
+        out << "not a cache file";
+    }
+    EXPECT_FALSE(cache.open(path, 1));
+
+    // A record count that only matches the file size after overflowing
+    {
+        std::ofstream out(path, std::ios::binary);
+        uint32_t version = 2;
+        uint64_t evaluator = 1;
+        uint64_t count = (1ULL << 60) + 1;
+        AnalysisRecord record = {};
+        out.write("CKAC", 4);
+        out.write(reinterpret_cast<const char*>(&version), sizeof(version));
+        out.write(reinterpret_cast<const char*>(&evaluator), sizeof(evaluator));
+        out.write(reinterpret_cast<const char*>(&count), sizeof(count));
+        out.write(reinterpret_cast<const char*>(&record), sizeof(record));
+    }
+    EXPECT_FALSE(cache.open(path, 1));
+    std::remove(path.c_str());
+}
+
+TEST_F(CheckersGameTest, AnalysisCacheIsReusedAcrossGames) {
+    const std::string path = "game_analysis.cache";
+    std::remove(path.c_str());
+
+    Move firstMove = game.getBestMove(3);
+    long long coldNodes = game.getNodesSearched();
+    ASSERT_TRUE(game.saveAnalysisCache(path));
+
+    CheckersGame rerun;
+    ASSERT_TRUE(rerun.loadAnalysisCache(path));
+    Move cachedMove = rerun.getBestMove(3);
+    EXPECT_LT(rerun.getNodesSearched(), coldNodes);
+    EXPECT_EQ(cachedMove.startRow, firstMove.startRow);
+    EXPECT_EQ(cachedMove.startCol, firstMove.startCol);
+    EXPECT_EQ(cachedMove.endRow, firstMove.endRow);
+    EXPECT_EQ(cachedMove.endCol, firstMove.endCol);
+
+    // Scores from the built-in evaluator must not be mixed with a network's
+    const std::string weightsPath = "cache_weights.nnue";
+    writeTestWeights(weightsPath);
+    ASSERT_TRUE(rerun.loadEvaluator(weightsPath));
+    EXPECT_EQ(rerun.analysisCache, nullptr);
+    EXPECT_FALSE(rerun.loadAnalysisCache(path));
+    std::remove(weightsPath.c_str());
+
+    std::remove(path.c_str());
+    std::remove((path + ".lock").c_str());
+}
+
 int main(int argc, char **argv) {
     ::testing::InitGoogleTest(&argc, argv);
     return RUN_ALL_TESTS();
@@ -88,16 +88,32 @@ bool getPlayerMove(CheckersGame& game) {
     return true;
 }
 
-int main() {
+int main(int argc, char* argv[]) {
     displayGameInstructions();
     int difficulty = getDifficultyLevel();
     CheckersGame game;
+
+    // Optional network evaluator: ./checkers [weights.nnue]
+    std::string weightsPath = (argc > 1) ? argv[1] : "checkers.nnue";
+    if (game.loadEvaluator(weightsPath)) {
+        std::cout << "Using neural network evaluator from " << weightsPath << "\n";
+    } else if (argc > 1) {
+        std::cout << "Could not load " << weightsPath << ", using the default evaluator\n";
+    }
+
+    // Search results saved by earlier games make repeated positions near-instant
+    const std::string cachePath = "checkers_analysis.cache";
+    game.loadAnalysisCache(cachePath);
     
     while (true) {
         game.printBoard();
         
         if (game.isGameOver()) {
-            std::cout << (game.isBlackTurn() ? "Red" : "Black") << " wins!\n";
+            if (game.isDraw()) {
+                std::cout << "Draw by repetition or no progress!\n";
+            } else {
+                std::cout << (game.isBlackTurn() ? "Red" : "Black") << " wins!\n";
+            }
             break;
         }
         
@@ -118,5 +134,8 @@ int main() {
         }
     }
     
+    if (!game.saveAnalysisCache(cachePath)) {
+        std::cout << "Could not save analysis cache to " << cachePath << "\n";
+    }
     return 0;
 }
\ No newline at end of file
@@ -0,0 +1,67 @@
+//Creators: Uzair Azizuddin Firas Al Halaq
+#ifndef MOVE_TABLES_H
+#define MOVE_TABLES_H
+
+/**
+ * Compile-time neighbour and jump tables for the 32 playable squares.
+ *
+ * Squares are numbered row by row, four per row: square = row * 4 + col / 2.
+ * Directions follow the order the move generators have always used:
+ * {+1,+1}, {+1,-1}, {-1,+1}, {-1,-1} as (row, col) steps. Red men move towards
+ * higher rows (directions 0-1), black men towards lower rows (directions 2-3) and
+ * kings use all four, so each piece kind owns a contiguous direction range.
+ *
+ * neighbour[s][d] is the adjacent square in direction d (also the square jumped
+ * over), jumpLanding[s][d] the square two steps away; both are NO_SQUARE when
+ * they would fall off the board.
+ */
+
+const int NUM_PLAYABLE_SQUARES = 32;
+const int NUM_DIRECTIONS = 4;
+const int NO_SQUARE = -1;
+
+constexpr int squareIndex(int row, int col) {
+    return row * 4 + col / 2;
+}
+
+struct MoveTables {
+    int row[NUM_PLAYABLE_SQUARES];
+    int col[NUM_PLAYABLE_SQUARES];
+    int neighbour[NUM_PLAYABLE_SQUARES][NUM_DIRECTIONS];
+    int jumpLanding[NUM_PLAYABLE_SQUARES][NUM_DIRECTIONS];
+};
+
+constexpr MoveTables buildMoveTables() {
+    const int directions[NUM_DIRECTIONS][2] = {{1, 1}, {1, -1}, {-1, 1}, {-1, -1}};
+    MoveTables tables{};
+    for (int row = 0; row < 8; row++) {
+        for (int col = (row + 1) % 2; col < 8; col += 2) {
+            int square = squareIndex(row, col);
+            tables.row[square] = row;
+            tables.col[square] = col;
+            for (int dir = 0; dir < NUM_DIRECTIONS; dir++) {
+                int stepRow = row + directions[dir][0];
+                int stepCol = col + directions[dir][1];
+                int jumpRow = row + 2 * directions[dir][0];
+                int jumpCol = col + 2 * directions[dir][1];
+                bool stepOnBoard = stepRow >= 0 && stepRow < 8 && stepCol >= 0 && stepCol < 8;
+                bool jumpOnBoard = jumpRow >= 0 && jumpRow < 8 && jumpCol >= 0 && jumpCol < 8;
+                tables.neighbour[square][dir] = stepOnBoard ? squareIndex(stepRow, stepCol) : NO_SQUARE;
+                tables.jumpLanding[square][dir] = jumpOnBoard ? squareIndex(jumpRow, jumpCol) : NO_SQUARE;
+            }
+        }
+    }
+    return tables;
+}
+
+constexpr MoveTables MOVE_TABLES = buildMoveTables();
+
+// Direction range per PieceType value: EMPTY, RED, BLACK, RED_KING, BLACK_KING
+constexpr int FIRST_DIRECTION[5] = {0, 0, 2, 0, 0};
+constexpr int LAST_DIRECTION[5] = {0, 2, 4, 4, 4};
+
+static_assert(MOVE_TABLES.neighbour[squareIndex(0, 1)][0] == squareIndex(1, 2), "forward neighbour of b1");
+static_assert(MOVE_TABLES.jumpLanding[squareIndex(0, 1)][1] == NO_SQUARE, "jump off the board edge");
+static_assert(MOVE_TABLES.jumpLanding[squareIndex(7, 6)][3] == squareIndex(5, 4), "black jump towards row 1");
+
+#endif
@@ -0,0 +1,160 @@
+/**
+ * This file contains the implementation of the NnueNetwork class, an optional
+ * evaluator used by CheckersGame in place of the hand-written material count.
+ *
+ * The first layer is an accumulator of int16 values that is updated one feature
+ * at a time by addFeature()/removeFeature(). evaluate() applies a clipped ReLU
+ * to the accumulator, runs one int8 hidden layer and a single output neuron.
+ * The inner loops work on fixed-size, aligned arrays so the compiler can
+ * vectorize them without hand-written intrinsics.
+ *
+ * The main methods include:
+ * - loadWeights(): Reads the network parameters from a weights file.
+ * - getFingerprint(): Returns a hash of the loaded parameters, used to tag saved analysis.
+ * - featureIndex(): Maps a playable square and piece kind to an input feature.
+ * - resetAccumulator(): Sets an accumulator to the empty-board state.
+ * - addFeature() / removeFeature(): Incrementally updates an accumulator.
+ * - evaluate(): Runs the remaining layers and returns a score for black.
+ */
+#include "nnue_eval.h"
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+
+
+namespace {
+    const char WEIGHTS_MAGIC[4] = {'C', 'K', 'N', 'N'};
+    const uint32_t WEIGHTS_VERSION = 1;
+    const int ACTIVATION_MAX = 127;
+    const int HIDDEN_SHIFT = 6;
+    const int OUTPUT_SHIFT = 8;
+
+    inline int8_t clippedRelu(int32_t value) {
+        return static_cast<int8_t>(value < 0 ? 0 : (value > ACTIVATION_MAX ? ACTIVATION_MAX : value));
+    }
+
+    // FNV-1a over raw parameter bytes, continuing from hash
+    uint64_t hashBytes(uint64_t hash, const void* data, size_t size) {
+        const unsigned char* bytes = static_cast<const unsigned char*>(data);
+        for (size_t i = 0; i < size; i++) {
+            hash = (hash ^ bytes[i]) * 0x100000001b3ULL;
+        }
+        return hash;
+    }
+
+    template <typename T>
+    bool readArray(std::ifstream& in, T* data, size_t count) {
+        in.read(reinterpret_cast<char*>(data), sizeof(T) * count);
+        return static_cast<bool>(in);
+    }
+}
+
+
+NnueNetwork::NnueNetwork() : outputBias(0), fingerprint(0) {
+    std::memset(featureBias, 0, sizeof(featureBias));
+    std::memset(featureWeights, 0, sizeof(featureWeights));
+    std::memset(hiddenBias, 0, sizeof(hiddenBias));
+    std::memset(hiddenWeights, 0, sizeof(hiddenWeights));
+    std::memset(outputWeights, 0, sizeof(outputWeights));
+}
+
+
+bool NnueNetwork::loadWeights(const std::string& path) {
+    std::ifstream in(path, std::ios::binary);
+    if (!in) {
+        return false;
+    }
+
+    char magic[4];
+    uint32_t version = 0;
+    if (!readArray(in, magic, 4) || std::memcmp(magic, WEIGHTS_MAGIC, 4) != 0) {
+        return false;
+    }
+    if (!readArray(in, &version, 1) || version != WEIGHTS_VERSION) {
+        return false;
+    }
+
+    // Read into a scratch copy so a truncated file leaves this network untouched. Trailing
+    // bytes mean the file has a different layout, so it is rejected as well.
+    NnueNetwork loaded;
+    bool ok = readArray(in, loaded.featureBias, HIDDEN1) &&
+              readArray(in, &loaded.featureWeights[0][0], NUM_FEATURES * HIDDEN1) &&
+              readArray(in, loaded.hiddenBias, HIDDEN2) &&
+              readArray(in, &loaded.hiddenWeights[0][0], HIDDEN2 * HIDDEN1) &&
+              readArray(in, &loaded.outputBias, 1) &&
+              readArray(in, loaded.outputWeights, HIDDEN2) &&
+              in.peek() == std::char_traits<char>::eof();
+    if (!ok) {
+        return false;
+    }
+
+    uint64_t hash = 0xcbf29ce484222325ULL;
+    hash = hashBytes(hash, loaded.featureBias, sizeof(loaded.featureBias));
+    hash = hashBytes(hash, loaded.featureWeights, sizeof(loaded.featureWeights));
+    hash = hashBytes(hash, loaded.hiddenBias, sizeof(loaded.hiddenBias));
+    hash = hashBytes(hash, loaded.hiddenWeights, sizeof(loaded.hiddenWeights));
+    hash = hashBytes(hash, &loaded.outputBias, sizeof(loaded.outputBias));
+    hash = hashBytes(hash, loaded.outputWeights, sizeof(loaded.outputWeights));
+    loaded.fingerprint = hash;
+
+    *this = loaded;
+    return true;
+}
+
+
+uint64_t NnueNetwork::getFingerprint() const {
+    return fingerprint;
+}
+
+
+int NnueNetwork::featureIndex(int square, int pieceKind) {
+    return square * NUM_PIECE_KINDS + pieceKind;
+}
+
+
+void NnueNetwork::resetAccumulator(NnueAccumulator& acc) const {
+    std::copy(featureBias, featureBias + HIDDEN1, acc.values);
+}
+
+
+void NnueNetwork::addFeature(NnueAccumulator& acc, int feature) const {
+    const int16_t* weights = featureWeights[feature];
+    for (int i = 0; i < HIDDEN1; i++) {
+        acc.values[i] += weights[i];
+    }
+}
+
+
+void NnueNetwork::removeFeature(NnueAccumulator& acc, int feature) const {
+    const int16_t* weights = featureWeights[feature];
+    for (int i = 0; i < HIDDEN1; i++) {
+        acc.values[i] -= weights[i];
+    }
+}
+
+
+int NnueNetwork::evaluate(const NnueAccumulator& acc) const {
+    // Clipped ReLU on the accumulator
+    alignas(16) int8_t input[HIDDEN1];
+    for (int i = 0; i < HIDDEN1; i++) {
+        input[i] = clippedRelu(acc.values[i]);
+    }
+
+    // Hidden dense layer followed by another clipped ReLU
+    alignas(16) int8_t hidden[HIDDEN2];
+    for (int j = 0; j < HIDDEN2; j++) {
+        int32_t sum = 0;
+        for (int i = 0; i < HIDDEN1; i++) {
+            sum += hiddenWeights[j][i] * input[i];
+        }
+        sum = (sum + hiddenBias[j]) >> HIDDEN_SHIFT;
+        hidden[j] = clippedRelu(sum);
+    }
+
+    // Output neuron
+    int32_t output = outputBias;
+    for (int j = 0; j < HIDDEN2; j++) {
+        output += outputWeights[j] * hidden[j];
+    }
+    return output >> OUTPUT_SHIFT;
+}
@@ -0,0 +1,68 @@
+//Creators: Uzair Azizuddin Firas Al Halaq
+#ifndef NNUE_EVAL_H
+#define NNUE_EVAL_H
+
+#include <cstdint>
+#include <string>
+
+/**
+ * Small quantized evaluation network with an incrementally updated first layer.
+ *
+ * Inputs are one feature per (playable square, piece kind): 32 squares x 4 kinds.
+ * The first layer is kept in an NnueAccumulator that the game updates as pieces
+ * are added to or removed from the board, so a full refresh is only needed when
+ * a network is loaded. The remaining layers are small int8 dense layers.
+ *
+ * Scores are from black's point of view, like CheckersGame::evaluateBoard().
+ * Nothing forces a network to score a color-swapped mirror as the negation, so
+ * CheckersGame does not share transposition entries between mirrored positions
+ * while a network is loaded.
+ *
+ * Weights file layout (little-endian):
+ *   char[4]  magic "CKNN"
+ *   uint32   version (1)
+ *   int16    featureBias[HIDDEN1]
+ *   int16    featureWeights[NUM_FEATURES][HIDDEN1]
+ *   int32    hiddenBias[HIDDEN2]
+ *   int8     hiddenWeights[HIDDEN2][HIDDEN1]
+ *   int32    outputBias
+ *   int8     outputWeights[HIDDEN2]
+ *
+ * loadWeights() rejects a file that is shorter or longer than this layout.
+ */
+
+struct NnueAccumulator;
+
+class NnueNetwork {
+    public:
+        static const int NUM_SQUARES = 32;
+        static const int NUM_PIECE_KINDS = 4;
+        static const int NUM_FEATURES = NUM_SQUARES * NUM_PIECE_KINDS;
+        static const int HIDDEN1 = 32;
+        static const int HIDDEN2 = 32;
+
+        NnueNetwork();
+        bool loadWeights(const std::string& path);
+        uint64_t getFingerprint() const;
+
+        static int featureIndex(int square, int pieceKind);
+        void resetAccumulator(NnueAccumulator& acc) const;
+        void addFeature(NnueAccumulator& acc, int feature) const;
+        void removeFeature(NnueAccumulator& acc, int feature) const;
+        int evaluate(const NnueAccumulator& acc) const;
+
+    private:
+        alignas(16) int16_t featureBias[HIDDEN1];
+        alignas(16) int16_t featureWeights[NUM_FEATURES][HIDDEN1];
+        alignas(16) int32_t hiddenBias[HIDDEN2];
+        alignas(16) int8_t hiddenWeights[HIDDEN2][HIDDEN1];
+        int32_t outputBias;
+        alignas(16) int8_t outputWeights[HIDDEN2];
+        uint64_t fingerprint;
+};
+
+struct NnueAccumulator {
+    alignas(16) int16_t values[NnueNetwork::HIDDEN1];
+};
+
+#endif
@@ -0,0 +1,74 @@
+/**
+ * Self-play benchmark: the AI plays both sides for a fixed number of games and
+ * reports how many positions were searched per second. It is also the training
+ * workload for the profile-guided build (see `make pgo`).
+ *
+ * Usage: checkers_selfplay [games] [difficulty] [max plies] [weights.nnue] [analysis cache]
+ *
+ * Pass "-" for the weights to keep the built-in evaluator. With an analysis cache,
+ * each game starts from the results saved so far and merges its own back in.
+ *
+ * Each game opens with a different first move so the runs cover more than one
+ * line. The last line of output is a summary that `make bench` parses.
+ */
+#include "ai_checkers.h"
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+int main(int argc, char* argv[]) {
+    int games = (argc > 1) ? std::atoi(argv[1]) : 4;
+    int difficulty = (argc > 2) ? std::atoi(argv[2]) : 2;
+    int maxPlies = (argc > 3) ? std::atoi(argv[3]) : 150;
+    std::string weightsPath = (argc > 4) ? argv[4] : "-";
+    std::string cachePath = (argc > 5) ? argv[5] : "";
+
+    long long totalNodes = 0;
+    int totalPlies = 0;
+    auto start = std::chrono::steady_clock::now();
+
+    for (int gameIndex = 0; gameIndex < games; gameIndex++) {
+        CheckersGame game;
+        if (weightsPath != "-" && !game.loadEvaluator(weightsPath)) {
+            std::cerr << "Could not load " << weightsPath << "\n";
+            return 1;
+        }
+        if (!cachePath.empty()) {
+            game.loadAnalysisCache(cachePath);
+        }
+
+        // Vary the opening move between games
+        std::vector<Move> openings = game.getAllValidMoves(game.isBlackTurn());
+        game.makeMove(openings[gameIndex % openings.size()]);
+
+        int plies = 1;
+        while (!game.isGameOver() && plies < maxPlies) {
+            game.makeMove(game.getBestMove(difficulty));
+            plies++;
+        }
+
+        std::string result = "unfinished";
+        if (game.isDraw()) {
+            result = "draw";
+        } else if (game.isGameOver()) {
+            result = game.isBlackTurn() ? "red wins" : "black wins";
+        }
+        std::cout << "Game " << gameIndex + 1 << ": " << plies << " plies, " << result
+                  << ", " << game.getNodesSearched() << " nodes\n";
+
+        if (!cachePath.empty() && !game.saveAnalysisCache(cachePath)) {
+            std::cerr << "Could not save " << cachePath << "\n";
+            return 1;
+        }
+
+        totalNodes += game.getNodesSearched();
+        totalPlies += plies;
+    }
+
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    double seconds = elapsed.count();
+    std::cout << "summary games " << games << " plies " << totalPlies << " nodes " << totalNodes
+              << " seconds " << seconds << " nps " << static_cast<long long>(totalNodes / seconds) << "\n";
+    return 0;
+}